@@ -28,6 +28,7 @@ enum um_EEcode_ {
 	, um_ERRINV      /**< Invalid arguments */
 	, um_ERRIMPL     /**< Not implemented */
 	, um_ERRSUPP     /**< Not supported. */
+	, um_ERRAGAIN    /**< Resource temporarily busy; retry later. */
 };
 
 
@@ -7,4 +7,209 @@
 
 #include "umbra.h"
 
+/*##############################################################################
+ * [[[   DEFINES   ]]]
+ */
+
+#define umO_NOSLOT   ((umO_Slot)-1) /**< A property lookup that found nothing. */
+#define umO_PICWAYS  (4)  /**< Entries in a polymorphic inline cache. */
+#define umO_MINSLOTS (4)  /**< Inline slots for objects created from the root
+                               when it has no size hint yet. */
+
+/* Number of bytes of an object with `n` inline slots (n >= 1). */
+#define umO_OBJSIZE(n) \
+	(offsetof(umO_Object, inl) + (size_t)(n) * sizeof(umO_Value))
+
+/* Address of slot `s` of object `O`, be it inline or out of line. */
+#define umO_SLOT(O, s) \
+	( (s) < (O)->inlsz ? &(O)->inl[(s)] : &(O)->ext[(s) - (O)->inlsz] )
+
+/* Walks the inline cache `C` for shape `H`, storing the slot in `s`.
+ * On a miss, `s` is umO_NOSLOT and the caller must go through
+ * umO_Pic_miss, which does the full lookup and refills the cache.
+ * Megamorphic sites always miss, without scanning the entries. */
+#define umO_PICGET(C, H, s) do { \
+		size_t umO_i_; \
+		(s) = umO_NOSLOT; \
+		if ((C)->state != umO_PIC_MEGA) { \
+			for (umO_i_ = 0; umO_i_ < (C)->n; umO_i_++) { \
+				if ((C)->shape[umO_i_] == (H)) { \
+					(s) = (C)->slot[umO_i_]; \
+					break; \
+				} \
+			} \
+		} \
+	} while (0)
+
+
+/*##############################################################################
+ * [[[   ENUMERATIONS   ]]]
+ */
+
+typedef enum umO_EType_ {
+
+	  umO_T_NIL    /**< No value; also the value of unset slots. */
+	, umO_T_BOOL   /**< Stored in `v.i`, as 0 or 1. */
+	, umO_T_INT    /**< Stored in `v.i`. */
+	, umO_T_FLOAT  /**< Stored in `v.f`. */
+	, umO_T_OBJECT /**< Stored in `v.p`, as an umO_Object*. */
+	, umO_T_GCREF  /**< Stored in `v.p`, any other collectable value. */
+
+	, umO_T_MAX
+} umO_EType;
+
+
+typedef enum umO_EPic_ {
+
+	  umO_PIC_EMPTY /**< No shape seen at this site yet. */
+	, umO_PIC_MONO  /**< Exactly one shape seen. */
+	, umO_PIC_POLY  /**< Between two and umO_PICWAYS shapes seen. */
+	, umO_PIC_MEGA  /**< More than umO_PICWAYS shapes; umO_PICGET always
+	                     misses and every access does the full lookup. */
+
+	, umO_PIC_MAX
+} umO_EPic;
+
+
+/*##############################################################################
+ * [[[   TYPE DEFINITIONS   ]]]
+ */
+
+typedef unsigned int umO_Slot;         /**< An index into an object's slots. */
+typedef struct umO_Keys_ umO_Keys;     /**< A table of interned property names. */
+typedef struct umO_Key_ umO_Key;       /**< An interned property name (opaque). */
+typedef struct umO_Value_ umO_Value;   /**< A tagged value, as stored in a slot. */
+typedef struct umO_Shape_ umO_Shape;   /**< A hidden class shared between objects. */
+typedef struct umO_Object_ umO_Object; /**< An object with inline property storage. */
+typedef struct umO_Pic_ umO_Pic;       /**< A polymorphic inline cache. */
+
+
+/*##############################################################################
+ * [[[   BASIC STRUCTS AND UNIONS   ]]]
+ */
+
+
+struct umO_Value_ {
+
+	umO_EType type;
+	union {
+		um_Int i;
+		um_Float f;
+		void* p;
+	} v;
+};
+
+
+/*
+ * Shapes are shared, and immutable except for the root's `inlsz` hint.
+ * Adding a property to an object moves it to a child shape, found through
+ * the parent's transition list; objects that get the same properties in the
+ * same order end up sharing the same shape, so property names and slot
+ * indexes are stored once per shape instead of once per object.
+ * Shapes are owned by their root, and freed with it; each constructor or
+ * record literal should have its own root, so that the hint only reflects
+ * objects of that kind.
+ * Shapes must outlive every umO_Pic caching them: before disposing a root,
+ * every PIC that may hold one of its shapes must be reset with umO_Pic_init
+ * (usually by disposing the root together with the code owning those PICs).
+ * Otherwise a new shape allocated at the same address would hit in the
+ * cache with a wrong slot.
+ */
+struct umO_Shape_ {
+
+	umO_Shape* parent;  /**< NULL for the root (empty) shape. */
+	const umO_Key* key; /**< The property added by this transition, which
+	                        lives in slot `nslots - 1`. NULL for the root. */
+	umO_Slot nslots;    /**< Number of properties; 0 for the root. */
+	umO_Slot inlsz;     /**< Only used on the root, which objects reach by
+	                        walking `parent`: the largest number of slots
+	                        reached by its objects, used to size the inline
+	                        slots of the next ones; 0 if none yet. Always 0
+	                        on other shapes. */
+
+	umO_Shape** trans;  /**< Child shapes, one per distinct key added. */
+	size_t ntrans;
+	size_t transsz;
+};
+
+
+/*
+ * Objects are allocated with umO_OBJSIZE(inlsz) bytes, the inline slots
+ * trailing the header, and there is no per-object table. `inlsz` is fixed
+ * at creation (see umO_Object_new), so a record with three fields usually
+ * costs the header (24 bytes on LP64) plus three values; smaller objects of
+ * the same kind may leave some trailing inline slots unused.
+ * Slots past `inlsz` live in `ext`, which only holds those, so inline slots
+ * stay in use after the object grows. Nothing points into the object itself,
+ * so it may be moved or copied (all of its umO_OBJSIZE bytes) with memcpy.
+ */
+struct umO_Object_ {
+
+	umO_Shape* shape;
+	umO_Value* ext;     /**< Slots from `inlsz` on; NULL if none. */
+	umO_Slot extsz;     /**< Capacity of `ext`. */
+	umO_Slot inlsz;     /**< Number of inline slots; at least 1. */
+	umO_Value inl[1];   /**< Actually inlsz values. */
+};
+
+
+/*
+ * One per field-access site in the bytecode. Entries are filled in the
+ * order shapes are seen, and never evicted; once full, the next new shape
+ * makes the site megamorphic for good, and umO_Pic_miss resets `n` to 0.
+ */
+struct umO_Pic_ {
+
+	umO_EPic state;
+	size_t n;
+	const umO_Shape* shape[umO_PICWAYS];
+	umO_Slot slot[umO_PICWAYS];
+};
+
+
+/*##############################################################################
+ * [[[   VARIABLES   ]]]
+ */
+
+
+
+
+/*##############################################################################
+ * [[[   FUNCTIONS   ]]]
+ */
+
+
+um_API umO_Keys* umO_Keys_open(um_Alloc* A);
+um_API void umO_Keys_dispose(um_Alloc* A, umO_Keys* K);
+
+/* Keys can only be obtained from here: equal names give the same key, so
+ * shapes compare keys by pointer. NULL if out of memory. */
+um_API const umO_Key* umO_Key_intern(um_Alloc* A, umO_Keys* K, const char* s, size_t sz);
+um_API const char* umO_Key_str(const umO_Key* key, size_t* sz);
+
+um_API umO_Shape* umO_Shape_root(um_Alloc* A);
+um_API void umO_Shape_dispose(um_Alloc* A, umO_Shape* root);
+um_API umO_Slot umO_Shape_lookup(const umO_Shape* H, const umO_Key* key);
+
+/* Gives the child of H with `key` added, creating it if needed, or H itself
+ * if `key` is already one of its properties. NULL if out of memory. */
+um_API umO_Shape* umO_Shape_add(um_Alloc* A, umO_Shape* H, const umO_Key* key);
+
+/* Creates an object with shape H and all of its slots nil. The number of
+ * inline slots is max(hint, H->nslots), the hint being the root's `inlsz`,
+ * or umO_MINSLOTS if both are 0. NULL if out of memory. */
+um_API umO_Object* umO_Object_new(um_Alloc* A, umO_Shape* H);
+um_API void umO_Object_dispose(um_Alloc* A, umO_Object* O);
+
+/* Gives the slot holding `key`, or NULL if there's none. Pointers to
+ * out-of-line slots are invalidated by any umO_Object_set that adds a
+ * property, as `ext` may be reallocated; inline slots stay put. */
+um_API umO_Value* umO_Object_get(umO_Object* O, const umO_Key* key);
+
+/* Also raises the root's `inlsz` hint when O grows past it. */
+um_API um_EEcode umO_Object_set(um_Alloc* A, umO_Object* O, const umO_Key* key, const umO_Value* v);
+
+um_API void umO_Pic_init(umO_Pic* C);
+um_API umO_Slot umO_Pic_miss(umO_Pic* C, const umO_Shape* H, const umO_Key* key);
+
 #endif /* UMBRA_OBJECT_H_ */
@@ -61,6 +61,8 @@ typedef enum umS_ENature_ {
 	, umS_NAT_BUFFER /**< The stream is buffered. */
 	, umS_NAT_FILE   /**< The stream is a file handle. */
 	, umS_NAT_STRING /**< The stream implements a string object. */
+	, umS_NAT_ASYNC  /**< The stream accepts asynchronous requests through
+	                      `submit`, completed through its umS_Aio. */
 
 	/* ... */
 
@@ -68,6 +70,23 @@ typedef enum umS_ENature_ {
 } umS_ENature;
 
 
+typedef enum umS_EAop_ {
+
+	  umS_AOP_NONE  /**< No operation; the request is free to be reused. */
+	, umS_AOP_READ  /**< Asynchronous read. */
+	, umS_AOP_WRITE /**< Asynchronous write. */
+	, umS_AOP_SYNC  /**< Drain barrier and flush: starts only after every
+	                     request submitted earlier on the same stream has
+	                     completed, then flushes; requests submitted after
+	                     it on that stream don't start until it completes.
+	                     The backend enforces the ordering (IOSQE_IO_DRAIN
+	                     on io_uring, holding jobs back on the pool), and
+	                     may also wait on other streams' requests. */
+
+	, umS_AOP_MAX
+} umS_EAop;
+
+
 /*##############################################################################
  * [[[   TYPE DEFINITIONS   ]]]
  */
@@ -85,6 +104,8 @@ typedef struct umS_Cconv_ umS_Cconv;   /**< An encoding conversion object. */
 /* Environment */
 typedef struct umS_Stream_ umS_Stream; /**< The base stream object. */
 typedef struct umS_Pos_ umS_Pos;       /**< An object representing a position inside a stream. */
+typedef struct umS_Areq_ umS_Areq;     /**< An asynchronous read/write request. */
+typedef struct umS_Aio_ umS_Aio;       /**< A shared asynchronous I/O context (ring or thread pool). */
 
 /* Streams */
 typedef struct umS_StreamApi_ umS_StreamApi;
@@ -92,6 +113,8 @@ typedef struct umS_State_ umS_State;
 typedef struct umS_Opts_ umS_Opts;
 
 /* Function signatures */
+/* When delivering completions from umS_Aio_complete, a non-zero return
+ * stops the delivery after this one; see umS_Aio_complete. */
 typedef int (*umS_FEvent)(void* state, um_EEcode ecode, umS_Stream* S, umS_Pos* P);
 typedef umS_Cconv* (*umS_FOpenconv)(umS_Ctrait* from, umS_Ctrait* to, umS_FAlloc allocf, void* allocp);
 
@@ -213,6 +236,34 @@ struct umS_Pos_ {
 };
 
 
+/*
+ * An asynchronous request. The caller owns its memory, and must keep it alive
+ * (and untouched) from `submit` until its completion is delivered.
+ * Completions are delivered from within umS_Aio_complete, on the caller's
+ * thread, by calling `eventf(eventp, ecode, S, &R->pos)`; because `pos` is
+ * the first member, the callback may cast the position back into the request.
+ * If `eventf` is NULL, the stream's `umS_Opts.eventf` is used instead.
+ */
+struct umS_Areq_ {
+
+	umS_Pos pos;        /**< Must be the first member. */
+	umS_EAop op;
+	char* buf;
+	size_t sz;          /**< The size of buf, in bytes. */
+	umS_Off off;        /**< Absolute offset, in bytes. If negative, submit
+	                        reserves the range at the stream's current
+	                        position: it stores that position here and
+	                        advances it by `sz` right away, so requests
+	                        submitted back to back get consecutive ranges.
+	                        The position is not rewound on short transfers. */
+	size_t done;        /**< Number of bytes transferred, set on completion. */
+	um_EEcode ecode;    /**< Result of the operation, set on completion. */
+	umS_FEvent eventf;
+	void* eventp;
+	void* backend;      /**< Reserved to the backend (SQE index, pool job). */
+};
+
+
 struct umS_Opts_ {
 
 	/* Basic */
@@ -221,6 +272,11 @@ struct umS_Opts_ {
 	umS_FEvent eventf;
 	void* eventp;
 	const char* mode; /**< The operational mode. */
+
+	/* Asynchronous */
+	umS_Aio* aio;     /**< The context asynchronous requests are submitted
+	                      into. Many streams may share the same context.
+	                      If NULL, the stream is not asynchronous. */
 };
 
 
@@ -268,6 +324,18 @@ struct umS_StreamApi_ {
 	um_EEcode (*setpos)(umS_StreamApi *A, umS_Stream* S, umS_Pos* pos);
 	um_EEcode (*tell)(umS_StreamApi *A, umS_Stream* S, umS_Off* off);
 	um_EEcode (*seek)(umS_StreamApi *A, umS_Stream* S, umS_Off off, int where);
+
+	/*
+	 * Asynchronous I/O. Only available if the stream has umS_NAT_ASYNC.
+	 * Requests are always binary; encoding, if any, is not considered.
+	 * submit queues the request into the stream's umS_Aio and returns
+	 * immediately, giving um_ERRSUPP if the stream is not asynchronous,
+	 * or um_ERRAGAIN if the context already has qdepth requests in flight,
+	 * in which case the caller should umS_Aio_complete and retry.
+	 * um_ERRMEM is only given on allocation failure.
+	 */
+
+	um_EEcode (*submit)(umS_StreamApi *A, umS_Stream* S, umS_Areq* R);
 };
 
 
@@ -286,6 +354,43 @@ struct umS_StreamApi_ {
 
 um_API void umS_Pos_dispose(umS_Pos* pos);
 
+um_API um_EEcode umS_Areq_submit(umS_Areq* R, umS_Stream* S);
+
+/*
+ * umS_Aio is opaque: the ring (io_uring) or thread pool behind asynchronous
+ * streams, created once and shared by all streams opened with it, so that
+ * reading many files at once costs a single ring, or a single pool, and
+ * completions for all of them are reaped in one place.
+ * The backend is chosen when opening: um_AIO_URING, um_AIO_THREADS, or 0 for
+ * um_AIOTYPE. If io_uring can't be set up at runtime, the context silently
+ * falls back to um_AIOFALLBACK; umS_Aio_type tells which one was chosen.
+ * A qdepth of 0 means um_AIOQDEPTH. Gives NULL on failure.
+ * The context must outlive all streams opened with it.
+ * A context is not thread-safe: `submit`, umS_Aio_complete and umS_Aio_close
+ * must all be called from the same thread (usually the scheduler's), which
+ * is also where completions are delivered. Pool workers never touch it.
+ */
+um_API umS_Aio* umS_Aio_open(umS_FAlloc allocf, void* allocp, size_t qdepth, int aiotype);
+
+/* Gives um_ERRAGAIN, leaving the context open, if requests are still in
+ * flight; the caller must umS_Aio_complete them first. */
+um_API um_EEcode umS_Aio_close(umS_Aio* C);
+
+um_API int umS_Aio_type(umS_Aio* C);
+um_API size_t umS_Aio_qdepth(umS_Aio* C);
+um_API size_t umS_Aio_inflight(umS_Aio* C);
+
+/* Delivers finished requests of all streams in C through their event
+ * callbacks, blocking until at least `min` requests finished. `min` is
+ * clamped to the number of requests in flight, so it never waits for
+ * requests that were not submitted; 0 never blocks. If a callback returns
+ * non-zero, delivery stops right after it, even if fewer than `min` were
+ * delivered, and the call gives um_OK; the rest stay queued for the next
+ * call. The number of completions delivered is stored in `*ndone` (if not
+ * NULL), even on error.
+ * Gives um_ERROR if the wait itself failed (e.g. io_uring_enter). */
+um_API um_EEcode umS_Aio_complete(umS_Aio* C, size_t min, size_t* ndone);
+
 um_API um_EEcode umS_Cconv_step(umS_Cconv* conv, size_t step);
 um_API um_EEcode umS_Cconv_dispose(umS_Cconv* conv);
 
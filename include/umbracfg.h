@@ -24,6 +24,9 @@
 #define um_FLOAT_FLOAT 4
 #define um_FLOAT_DOUBLE 5
 #define um_FLOAT_LDOUBLE 6
+#define um_AIO_NONE 7
+#define um_AIO_THREADS 8
+#define um_AIO_URING 9
 #define um_MAJORBITS 6
 #define um_MINORBITS 11
 #define um_PATCHBITS 15
@@ -45,6 +48,9 @@
 #define um_PATCHVERSION (0)/*@@PATCHVERSION@@*/
 #define um_INTTYPE um_INT_LONG/*@@INTTYPE@@*/
 #define um_FLOATTYPE um_FLOAT_DOUBLE/*@@FLOATTYPE@@*/
+#define um_AIOTYPE um_AIO_URING/*@@AIOTYPE@@*/
+#define um_AIOTHREADS (4)/*@@AIOTHREADS@@*/
+#define um_AIOQDEPTH (64)/*@@AIOQDEPTH@@*/
 
 
 /*
@@ -6,6 +6,7 @@
 #define UMBRADEF_H_
 
 #include "umbracfg.h"
+#include <stddef.h>
 
 
 /*
@@ -96,4 +97,41 @@
 typedef um_TYPE_INT um_Int;
 typedef um_TYPE_FLOAT um_Float;
 
+
+/*
+ * [ A S Y N C   I / O ] =======================================================
+ * io_uring is only available on Linux; everywhere else, asynchronous streams
+ * fall back to a pool of um_AIOTHREADS threads doing blocking calls.
+ */
+
+#ifndef um_AIOTYPE
+#	define um_AIOTYPE um_AIO_THREADS
+#endif
+
+#if um_AIOTYPE == um_AIO_URING && !defined(__linux__)
+#	undef um_AIOTYPE
+#	define um_AIOTYPE um_AIO_THREADS
+#endif
+
+#if um_AIOTYPE == um_AIO_URING
+#	define um_AIONAME "io_uring"
+#	define um_AIOFALLBACK um_AIO_THREADS /* Used if io_uring_setup fails at runtime. */
+#elif um_AIOTYPE == um_AIO_THREADS
+#	define um_AIONAME "threads"
+#	define um_AIOFALLBACK um_AIO_NONE
+#elif um_AIOTYPE == um_AIO_NONE
+#	define um_AIONAME "none"
+#	define um_AIOFALLBACK um_AIO_NONE
+#else
+#	error Unknown asynchronous I/O backend.
+#endif
+
+#ifndef um_AIOTHREADS
+#	define um_AIOTHREADS (4)
+#endif
+
+#ifndef um_AIOQDEPTH
+#	define um_AIOQDEPTH (64)
+#endif
+
 #endif